@@ -0,0 +1,43 @@
+// Registry of channels seen in the data
+// ---------------------------------------------------------
+// Each ChannelAddress is given a dense Id the first time it is seen and its
+// ChannelName is decoded once.  The sorts then look up the decoded name and
+// the alternate energy/wave calibration coefficients with GetChannel()
+// rather than parsing the name and searching the calibration lists for every
+// fragment.  Requires SortTrees.h (Mnemonic) to be included first.
+
+#define CHANNEL_MAX 4096        // Max channels in registry
+#define CHANNEL_TABLE_SIZE 8192 // Size of address look up table, power of 2 and > CHANNEL_MAX
+
+struct ChannelInfo {
+   int Id;                      // Dense channel number, in the order channels were first seen
+   int Address;                 // ChannelAddress
+    std::string Name;           // ChannelName of first fragment seen on this address
+   bool NameOK;                 // Name long enough to decode, nothing below is set if not
+   Mnemonic mnemonic;           // Decoded name
+   int Chan;                    // ChannelAddress & 0xFF, 0 = core a, 9 = core b for core channels
+   bool Tigress;                // mnemonic.system == "TI"
+   bool Ge;                     // mnemonic.subsystem == "G"
+   char Colour;                 // mnemonic.arraysubposition
+   char Sensor;                 // mnemonic.outputsensor
+   int Clover;                  // 1-16
+   int Crystal;                 // 0-3, -1 if colour is bad
+   int Seg;                     // 0 core a, 1-8 segments, 9 core b (seg 0 on chan 9)
+   // Alternate calibration, 0 if there is none for this channel
+   std::vector < float >*EnCoeffs;
+   std::vector < float >*WaveCoeffs;
+};
+
+// --------------------------------------------------------
+// Functions:
+// --------------------------------------------------------
+// Empty the registry.  Calibration files must be read before this as coefficients are found when
+// channels are registered.
+int InitChannels();
+// Add any channels in ev not already known.  Main thread only, before the event is passed on.
+void RegisterChannels(EventView & ev);
+// Look up channel of fragment, any thread.  0 if not registered.
+ChannelInfo *GetChannel(TTigFragment & Frag);
+int NumChannels();
+// Do two names refer to the same channel?  First 9 characters must match exactly, 10th (a/b/x) ignoring case.
+bool ChannelNamesMatch(const std::string & Name1, const std::string & Name2);
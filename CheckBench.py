@@ -0,0 +1,183 @@
+#!/usr/bin/python
+# Compare calibrations recovered from MakeFragTree files with the values put in.
+# Used by RunBench.sh.
+#
+# CheckBench.py -g GainsOut.txt TruthGains.txt [-w WaveGainsOut.txt TruthWaveGains.txt]
+#               [-x PropXTalkOut.txt TruthXTalk.txt] [-s Spectra.root] [-c Clovers] [-e keV] [-t XTalkTol]
+#
+# Gains: the recovered and true calibrations must give the same energy, within -e keV (default 1.0),
+# at the charge the true calibration puts at 1332.5 keV.  Missing or failed channels fail.
+# Crosstalk: seg to seg values within each crystal must agree within -t (default 0.0005) for at
+# least 90% of pairs.
+# Spectra: the file must have at least one spectrum with counts in it, so a sort that finds none of
+# its channels fails (needs PyROOT).  -s may be given more than once.  Returns 0 if everything agrees.
+from __future__ import print_function
+import sys
+
+CRYSTALS = 4
+SEGS = 8
+CHECK_EN = 1332.501
+XTALK_GOOD_FRAC = 0.9
+
+def ReadGains(FileName):
+   Gains = {}
+   for Line in open(FileName):
+      Items = Line.split()
+      if (len(Items) < 2 or len(Items[0]) != 10 or not Items[0].startswith("TIG")):
+         continue
+      Name = Items[0][:9] + Items[0][9].lower()
+      try:
+         Gains[Name] = [float(x) for x in Items[2:]]
+      except ValueError:
+         Gains[Name] = None      # "Fail!!!"
+   return Gains
+
+def CalEnergy(Gain, Charge):
+   return sum(g * Charge**i for i, g in enumerate(Gain))
+
+def CheckGains(OutFile, TruthFile, Clovers, Tol):
+   Out = ReadGains(OutFile)
+   Truth = ReadGains(TruthFile)
+   Bad = 0
+   Worst = 0.0
+   Checked = 0
+   for Name in sorted(Truth):
+      if (int(Name[3:5]) > Clovers):
+         continue
+      Checked += 1
+      Gain = Out.get(Name)
+      if (Gain == None or len(Gain) < 2):
+         print("   " + Name + ": no calibration")
+         Bad += 1
+         continue
+      TrueGain = Truth[Name]
+      Charge = (CHECK_EN - TrueGain[0]) / TrueGain[1]
+      Diff = CalEnergy(Gain, Charge) - CHECK_EN
+      Worst = max(Worst, abs(Diff))
+      if (abs(Diff) > Tol):
+         print("   %s: %.2f keV off at %.1f keV" % (Name, Diff, CHECK_EN))
+         Bad += 1
+   print("%s: %d of %d channels good, worst %.3f keV" % (OutFile, Checked - Bad, Checked, Worst))
+   return Bad == 0
+
+# Blocks of (SEGS+2)*CRYSTALS rows, one for each clover
+def ReadXTalk(FileName):
+   XTalk = []
+   for Line in open(FileName):
+      Items = Line.split()
+      if (len(Items) == (SEGS + 2) * CRYSTALS):
+         XTalk.append([float(x) for x in Items])
+   return XTalk
+
+def CheckXTalk(OutFile, TruthFile, Clovers, Tol):
+   Out = ReadXTalk(OutFile)
+   Truth = ReadXTalk(TruthFile)
+   Rows = (SEGS + 2) * CRYSTALS
+   if (len(Out) < Clovers * Rows or len(Truth) < Clovers * Rows):
+      print(OutFile + ": expected " + str(Clovers * Rows) + " rows of crosstalk")
+      return False
+   Good = 0
+   Checked = 0
+   SumDiff = 0.0
+   for Clover in range(Clovers):
+      for Crystal in range(CRYSTALS):
+         for Hit in range(1, SEGS + 1):
+            for Other in range(1, SEGS + 1):
+               if (Other == Hit):
+                  continue
+               Row = Clover * Rows + Crystal * (SEGS + 2) + Hit
+               Col = Crystal * (SEGS + 2) + Other
+               Diff = abs(Out[Row][Col] - Truth[Row][Col])
+               SumDiff += Diff
+               Checked += 1
+               if (Diff <= Tol):
+                  Good += 1
+   print("%s: %d of %d seg pairs within %g, mean difference %.5f" % (OutFile, Good, Checked, Tol, SumDiff / Checked))
+   return Good >= XTALK_GOOD_FRAC * Checked
+
+# Spectra in Dir and the directories below it: (number, number with counts, total entries)
+def CountSpectra(Dir):
+   Spectra = 0
+   Filled = 0
+   Entries = 0.0
+   for Key in Dir.GetListOfKeys():
+      Obj = Key.ReadObj()
+      if (Obj.InheritsFrom("TDirectory")):
+         Sub = CountSpectra(Obj)
+         Spectra += Sub[0]
+         Filled += Sub[1]
+         Entries += Sub[2]
+      elif (Obj.InheritsFrom("TH1")):
+         Spectra += 1
+         if (Obj.GetEntries() > 0):
+            Filled += 1
+            Entries += Obj.GetEntries()
+   return (Spectra, Filled, Entries)
+
+def CheckSpectra(FileName):
+   try:
+      import ROOT
+   except ImportError:
+      print(FileName + ": can't check spectra without PyROOT")
+      return False
+   File = ROOT.TFile.Open(FileName)
+   if (not File or File.IsZombie()):
+      print(FileName + ": can't open")
+      return False
+   Spectra, Filled, Entries = CountSpectra(File)
+   File.Close()
+   print("%s: %d of %d spectra have counts, %d entries" % (FileName, Filled, Spectra, Entries))
+   return Filled > 0
+
+def Usage():
+   print("CheckBench.py -g GainsOut.txt TruthGains.txt [-w WaveGainsOut.txt TruthWaveGains.txt]")
+   print("              [-x PropXTalkOut.txt TruthXTalk.txt] [-s Spectra.root] [-c Clovers] [-e keV] [-t XTalkTol]")
+   sys.exit(2)
+
+Checks = []
+Clovers = 16
+EnTol = 1.0
+XTalkTol = 0.0005
+i = 1
+try:
+   while (i < len(sys.argv)):
+      if (sys.argv[i] in ("-g", "-w", "-x")):
+         Checks.append((sys.argv[i], sys.argv[i + 1], sys.argv[i + 2]))
+         i += 3
+      elif (sys.argv[i] == "-s"):
+         Checks.append((sys.argv[i], sys.argv[i + 1]))
+         i += 2
+      elif (sys.argv[i] == "-c"):
+         Clovers = int(sys.argv[i + 1])
+         i += 2
+      elif (sys.argv[i] == "-e"):
+         EnTol = float(sys.argv[i + 1])
+         i += 2
+      elif (sys.argv[i] == "-t"):
+         XTalkTol = float(sys.argv[i + 1])
+         i += 2
+      else:
+         Usage()
+except (IndexError, ValueError):
+   Usage()
+if (len(Checks) == 0):
+   Usage()
+
+Ok = True
+for Check in Checks:
+   try:
+      if (Check[0] == "-s"):
+         Ok = CheckSpectra(Check[1]) and Ok
+      elif (Check[0] == "-x"):
+         Ok = CheckXTalk(Check[1], Check[2], Clovers, XTalkTol) and Ok
+      else:
+         Ok = CheckGains(Check[1], Check[2], Clovers, EnTol) and Ok
+   except IOError as e:
+      print(e)
+      Ok = False
+
+if (Ok):
+   print("Calibrations match what was put in and every sort filled its spectra.")
+   sys.exit(0)
+print("Calibrations DO NOT match what was put in, or a sort filled no spectra!")
+sys.exit(1)
@@ -0,0 +1,64 @@
+#!/bin/bash
+# Check that partial results (SortTrees -P + MergePartials) give the same gain drift fit times as one sort
+# ---------------------------------------------------------------------------------------
+# Makes two FragmentTree files with MakeFragTree, the second following on from the first at a
+# whole number of drift time bins, and sorts them (--cal) three ways:
+#    serial  - SortTrees on both files
+#    partial - SortTrees -P on each file, then MergePartials with the later file first, so the
+#              earlier partial moves the drift record and fit times back when it is read
+# The time of the last drift fit reported by FinalCalib() must be the same both ways.
+#
+# Run from the directory with the compiled SortTrees, MergePartials and MakeFragTree.
+# Usage: ./CheckPartials.sh [-n Events per file] [-r Rate] [-b BinSize] [-o Dir]
+# BinSize is MAX_TIME / TIME_BINS of the Config.txt used (1800 s as shipped).
+
+Events=100000
+Rate=20
+BinSize=1800
+Dir=CheckPartials
+Bin=$(pwd)
+
+while [ $# -gt 0 ]; do
+   case "$1" in
+      -n) Events=$2; shift 2 ;;
+      -r) Rate=$2; shift 2 ;;
+      -b) BinSize=$2; shift 2 ;;
+      -o) Dir=$2; shift 2 ;;
+      *) echo "Unknown option $1, see top of CheckPartials.sh"; exit 2 ;;
+   esac
+done
+
+for Prog in MakeFragTree SortTrees MergePartials; do
+   if [ ! -x "$Bin/$Prog" ]; then
+      echo "$Bin/$Prog not found, compile it first (see README.md)"
+      exit 2
+   fi
+done
+ConfigOpt=""
+if [ -f "$Bin/Config.txt" ]; then
+   ConfigOpt="-c $Bin/Config.txt"
+fi
+
+mkdir -p "$Dir"/serial "$Dir"/first "$Dir"/second "$Dir"/merged
+cd "$Dir" || exit 2
+
+# First file from 0 s, second from the next time bin boundary after it ends
+"$Bin/MakeFragTree" -o First.root -t Truth -n $Events -r $Rate -c 4 -w 0 > First.log 2>&1 || { echo "MakeFragTree failed, see $Dir/First.log"; exit 1; }
+Length=$(sed -n 's/.* \([0-9.e+]*\) s of beam).*/\1/p' First.log)
+Start=$(awk -v L=$Length -v B=$BinSize 'BEGIN { print (int(L / B) + 1) * B }')
+"$Bin/MakeFragTree" -o Second.root -t Truth -n $Events -r $Rate -c 4 -w 0 -T $Start > Second.log 2>&1 || { echo "MakeFragTree failed, see $Dir/Second.log"; exit 1; }
+echo "First file $Length s, second starts at $Start s"
+
+"$Bin/SortTrees" $ConfigOpt -f First.root Second.root -s 60Co -o serial/ --cal > serial.log 2>&1
+"$Bin/SortTrees" $ConfigOpt -f First.root -s 60Co -o first/ -P --cal > first.log 2>&1
+"$Bin/SortTrees" $ConfigOpt -f Second.root -s 60Co -o second/ -P --cal > second.log 2>&1
+"$Bin/MergePartials" $ConfigOpt -f second/Partial.root first/Partial.root -s 60Co -o merged/ > merged.log 2>&1
+
+Serial=$(sed -n 's/^Last gain drift fit \([0-9.e+-]*\) s.*/\1/p' serial.log)
+Merged=$(sed -n 's/^Last gain drift fit \([0-9.e+-]*\) s.*/\1/p' merged.log)
+echo "Last gain drift fit: serial ${Serial:--} s, merged partials ${Merged:--} s"
+if [ -z "$Serial" ] || [ "$Serial" != "$Merged" ]; then
+   echo "FAIL: fit times differ (logs in $Dir)"
+   exit 1
+fi
+echo "OK"
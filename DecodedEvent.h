@@ -0,0 +1,65 @@
+// Decoded events
+// ---------------------------------------------------------
+// Each built event is decoded once, on the thread that sorts it, and the
+// result passed to all the sorts (CoincEff, Calib, PropXtalk, GeTiming) in
+// place of the fragments.  Decoding looks up the channel, calibrates the
+// energy and wave energy and applies the usual thresholds, so none of this is
+// repeated by each sort.
+//
+// Hits[] has one entry for every fragment with a good channel name, in the
+// order of the fragments.  TIGRESS HPGe hits are also stored by position in
+// Clovers[], which is all zero except where this event has hits.
+// Requires Options.h and EventView.h to be included first.
+
+// Hit flags
+#define HIT_GE      0x01        // TIGRESS HPGe with good clover/crystal/seg, also in Clovers[]
+#define HIT_ENERGY  0x02        // Energy > Config.EnergyThresh
+#define HIT_CHARGE  0x04        // Charge > 0 and passes TestChargeHit()
+#define HIT_WAVE    0x08        // Charge > 0 and WaveCharge passes TestChargeHit()
+
+struct ChannelInfo;             // ChannelRegistry.h
+
+struct Hit {
+   TTigFragment *Frag;
+   ChannelInfo *Info;
+   int Clover;                  // 1-16, as Info, only good if HIT_GE
+   int Crystal;                 // 0-3
+   int Seg;                     // 0 core a, 1-8 segments, 9 core b
+   int Charge;
+   float Energy;                // Alternate calibration if there is one for the channel, otherwise ChargeCal
+   float WaveCharge;            // 0 if waveform not analysed or too short
+   float WaveEnergy;            // 0 if no wave calibration for the channel
+   int TimeToTrig;
+   unsigned int Flags;
+};
+
+struct CloverHits {             // Last hit seen at each position, 0 if none
+   unsigned int Flags[CRYSTALS][SEGS + 2];
+   int Charge[CRYSTALS][SEGS + 2];
+   float Energy[CRYSTALS][SEGS + 2];
+   float WaveCharge[CRYSTALS][SEGS + 2];
+   float WaveEnergy[CRYSTALS][SEGS + 2];
+   int TimeToTrig[CRYSTALS][SEGS + 2];
+   int CoreFold;                // Cores (seg 0) with HIT_ENERGY
+   int SegFold[CRYSTALS];       // Segments with HIT_ENERGY
+};
+
+struct DecodedEvent {
+   unsigned int NumHits;
+   std::vector < Hit > Hits;    // Kept full size, Hits[0 - NumHits-1] are this event
+   CloverHits Clovers[CLOVERS]; // Clovers[Clover-1]
+   bool CloverHit[CLOVERS];     // Any HIT_GE in this clover
+   int CloverList[CLOVERS];     // Clovers hit, in order first seen.  Cleared before the next event.
+   int NumClovers;
+   int CloverFold;              // Clovers with CoreFold > 0
+   int CrystalFold;             // Sum of CoreFold
+   int SegFold;                 // Sum of SegFold
+};
+
+// --------------------------------------------------------
+// Functions:
+// --------------------------------------------------------
+// Initialise a new DecodedEvent
+void InitDecoded(DecodedEvent * Event);
+// Decode ev.  Channels must be registered and, for wave charge/energy, waveforms analysed.
+void DecodeEvent(EventView & ev, DecodedEvent * Event);
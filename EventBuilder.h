@@ -0,0 +1,46 @@
+// Event building from a FragmentTree read in storage order
+// ---------------------------------------------------------
+// Fragments are read sequentially and grouped by TriggerId.  A small number
+// of events are held "open" at any time so that fragments arriving slightly
+// out of order are still collected.  Once more than Window events are open the
+// one with the lowest TriggerId is taken to be complete and is passed on.
+// Fragments come from the tree, or with -ra from the read ahead thread one file
+// at a time.
+// Requires EventView.h and ReadAhead.h to be included first.
+
+struct BuilderSlot {            // One open event
+   bool Used;
+   int TriggerId;
+   FragStore Frags;
+};
+
+struct EventBuilder {
+   TTree *Tree;
+   TBranch *Branch;
+   TTigFragment *pFrag;         // fragment address the branch is read in to
+   Long64_t NextEntry;          // next tree entry to be read
+   Long64_t NumEntries;
+   ReadAhead *Source;           // if not 0, fragments are from here rather than the tree
+   bool Finished;               // no more fragments in this tree
+   int Window;                  // number of events held open
+   std::vector < BuilderSlot > Slots;
+   int NumOpen;
+   bool HaveEmitted;            // Has any event been passed on yet?
+   int LastTriggerId;           // TriggerId of the last event passed on
+   // Counters
+   unsigned int FragsRead;
+   unsigned int EventsBuilt;
+   unsigned int LateFrags;      // frags arriving after their event was built (dropped)
+};
+
+// --------------------------------------------------------
+// Functions:
+// --------------------------------------------------------
+// Setup builder for a new tree
+int InitEventBuilder(EventBuilder * Builder, TTree * Tree, TBranch * Branch, TTigFragment * pFrag, int Window);
+// Setup builder for the next file of a read ahead
+int InitReadAheadBuilder(EventBuilder * Builder, ReadAhead * Source, int Window);
+// Swap the next built event in to ev.  Returns 0 on success, 1 when the tree is exhausted.
+int BuildNextEvent(EventBuilder * Builder, FragStore * ev);
+// Delete fragment storage
+void FreeEventBuilder(EventBuilder * Builder);
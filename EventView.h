@@ -0,0 +1,62 @@
+// Storage for the fragments of built events
+// ---------------------------------------------------------
+// A FragStore owns the fragments of one event.  Fragments are allocated the
+// first time they are needed and then kept, along with their waveform
+// buffers, when the store is cleared so the next event is copied in to the
+// same memory.  Events are passed around by swapping stores, which only
+// swaps pointers, so once the event loop has warmed up it makes no heap
+// allocations.
+//
+// The sorts see an event through an EventView, which doesn't own anything and
+// can be indexed like the old std::vector<TTigFragment>: ev.size(), ev[i].
+// Results of waveform analysis (WaveAnalysis.C) are stored alongside the
+// fragments, ev.Waves[i] is for fragment ev[i].
+
+struct WaveFeatures {           // Found once per waveform by AnalyseWaves()
+   bool Valid;                  // Long enough for charge evaluation
+   bool ChargeOK;               // Longer than the charge windows, so Charge is used by the sorts
+   float Baseline;              // Mean of first Config.WaveInitialSamples
+   float Charge;                // Mean of last Config.WaveFinalSamples - Baseline, as CalcWaveCharge()
+   float TrapEnergy;            // Height of trapezoidal filter (Config.WaveTrapRise, WaveTrapGap), 0 if off
+   float CfdTime;               // Constant fraction zero crossing in samples, -1 if not found or off
+};
+
+struct FragStore {
+   std::vector < TTigFragment * >Frags; // Frags[0 - NumFrags-1] are this event, any after are spare
+   unsigned int NumFrags;
+   std::vector < WaveFeatures > Waves;  // Waves[i] for Frags[i], kept full size like Frags
+   unsigned int NumWaves;       // = NumFrags once analysed, 0 if not
+};
+
+struct EventView {
+   TTigFragment **Frags;
+   unsigned int NumFrags;
+   WaveFeatures *Waves;         // 0 if waveforms have not been analysed
+
+   unsigned int size() const {
+      return NumFrags;
+   }
+   TTigFragment & operator[] (unsigned int i) const {
+      return *Frags[i];
+   }
+};
+
+// --------------------------------------------------------
+// Functions:
+// --------------------------------------------------------
+// Empty store, keeping fragments for reuse.  Also use to initialise a new store.
+void ClearFrags(FragStore * Store);
+// Copy Frag in to the next free fragment of the store
+void AddFrag(FragStore * Store, TTigFragment & Frag);
+// Next free fragment of the store, to be filled in place.  Fields not set keep old values.
+TTigFragment *NextFrag(FragStore * Store);
+// Exchange the contents of two stores
+void SwapFrags(FragStore * Store1, FragStore * Store2);
+// Order fragments by FragmentId, as GetEntryWithIndex(TriggerId, FragmentId) would give them
+void SortFrags(FragStore * Store);
+// Delete all fragments, including spares
+void FreeFrags(FragStore * Store);
+EventView MakeView(FragStore * Store);
+
+// Count of heap allocations (operator new) made by the whole program so far
+unsigned long long GetAllocCount();
@@ -0,0 +1,94 @@
+// Histogram accumulators
+// ---------------------------------------------------------
+// Plain integer bin counts for a block of spectra with the same fixed binning,
+// e.g. every charge spectrum in Calib.C, held in one contiguous array and
+// indexed by a dense spectrum number.  Filling finds the bin by multiplying and
+// truncating and adds one, with no virtual calls, so it is much cheaper than
+// TH1::Fill().  The sums TH1::Fill() keeps for the statistics (mean, RMS) are
+// kept too, from the filled values, so at the end of the sort each spectrum is
+// copied in to the usual TH1F/TH2F (AccToHisto()) with the same bins, entries
+// and statistics as if it had been filled directly, and written as before.
+//
+// Bins are numbered as ROOT numbers them: 0 underflow, 1 - NumBins, NumBins+1
+// overflow, and for 2D, X + (NumBinsX + 2) * Y.  Values are put in the same
+// bin as TH1::Fill() would, apart from possible rounding within a hair of a
+// bin edge.  Only unit weight fills are supported.
+// Requires TH1.h to be included first.
+
+#define ACC_STATS 7                     // sum w, w^2, wx, wx^2, wy, wy^2, wxy, as TH1::GetStats()
+
+struct AccAxis {
+   int NumBins;
+   double Min;
+   double Max;
+   double Scale;                // NumBins / (Max - Min)
+};
+
+struct HistAcc {
+   int NumHists;
+   AccAxis X;
+   AccAxis Y;                   // Y.NumBins = 0 for 1D
+   unsigned int HistSize;       // Bins per spectrum, including under/overflow
+   unsigned int *Bins;          // Bins[Hist * HistSize + Bin]
+   double *Stats;               // Stats[Hist * ACC_STATS + Sum], of fills within the axes, unit weight
+};
+
+// --------------------------------------------------------
+// Functions:
+// --------------------------------------------------------
+// Allocate zeroed bins for NumHists 1D or 2D spectra.  0 if OK.
+int InitAcc1D(HistAcc * Acc, int NumHists, int NumBins, double Min, double Max);
+int InitAcc2D(HistAcc * Acc, int NumHists, int NumBinsX, double MinX, double MaxX, int NumBinsY, double MinY, double MaxY);
+void FreeAcc(HistAcc * Acc);
+// Per-thread copies and partial results, as ShardHisto() (SHARD_CLONE/MERGE/WRITE/READ from Utils.h)
+void ShardAcc(HistAcc * Master, HistAcc * Acc, int Mode);
+// Replace the contents of Histo with spectrum Hist.  Binning of Histo must match.
+void AccToHisto(HistAcc * Acc, int Hist, TH1 * Histo);
+
+inline int AccBin(const AccAxis & Axis, double Value)
+{
+   int Bin;
+
+   if (Value < Axis.Min) {
+      return 0;
+   }
+   if (!(Value < Axis.Max)) {   // NaN to overflow, as TAxis::FindFixBin()
+      return Axis.NumBins + 1;
+   }
+   Bin = 1 + (int) ((Value - Axis.Min) * Axis.Scale);
+   return (Bin > Axis.NumBins) ? Axis.NumBins : Bin;
+}
+
+inline void AccFill(HistAcc * Acc, int Hist, double X)
+{
+   int Bin = AccBin(Acc->X, X);
+   double *Stats;
+
+   Acc->Bins[Hist * Acc->HistSize + Bin] += 1;
+   if (Bin > 0 && Bin <= Acc->X.NumBins) {     // TH1::Fill() leaves under/overflow out of the stats
+      Stats = &Acc->Stats[Hist * ACC_STATS];
+      Stats[0] += 1;
+      Stats[1] += 1;
+      Stats[2] += X;
+      Stats[3] += X * X;
+   }
+}
+
+inline void AccFill(HistAcc * Acc, int Hist, double X, double Y)
+{
+   int BinX = AccBin(Acc->X, X);
+   int BinY = AccBin(Acc->Y, Y);
+   double *Stats;
+
+   Acc->Bins[Hist * Acc->HistSize + BinX + (Acc->X.NumBins + 2) * BinY] += 1;
+   if (BinX > 0 && BinX <= Acc->X.NumBins && BinY > 0 && BinY <= Acc->Y.NumBins) {
+      Stats = &Acc->Stats[Hist * ACC_STATS];
+      Stats[0] += 1;
+      Stats[1] += 1;
+      Stats[2] += X;
+      Stats[3] += X * X;
+      Stats[4] += Y;
+      Stats[5] += Y * Y;
+      Stats[6] += X * Y;
+   }
+}
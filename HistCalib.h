@@ -10,7 +10,7 @@ int FitHistoFile(TFile * file, int FileType, int FileNum, MasterFitMap * FitMap,
 // Find/id first two peaks, rough calibration, loop all peaks
 int FitGammaSpectrum(TH1F * Histo, HistoFit * Fit, HistoCal * Cal, FitSettings Settings);
 // Fit a peak
-int FitSinglePeak(TH1F * Histo, int Line, float Energy, TF1 * FitRange, FitResult * FitRes, FitSettings Settings);
+int FitSinglePeak(TH1F * Histo, int Line, float Energy, FitResult * FitRes, FitSettings Settings);
 
 // Functions for calibration
 // --------------------------
@@ -0,0 +1,38 @@
+// Index of spectra in histogram files (SortHistos and SegCoreCalib input)
+// ---------------------------------------------------------
+// The keys of every directory in the file are listed once, when it is opened,
+// giving the directory each spectrum is in.  A channel's spectrum is then read
+// straight from its key, by the same name (made from Clover, Crystal, Seg and the
+// kind of spectrum) the calibration used to search the whole file for, and only
+// when that channel is fitted.  Spectra read from the file belong to the caller
+// and should be released once fitted and written, so only the spectra of the
+// channels being calibrated are ever in memory.
+// Online analyser files keep everything in the "histos" TFolder, which can only
+// be read as a whole, its contents are indexed as well and never released.
+// With HIST_INDEX_CACHE 1 in Config.txt the index is saved next to the file as
+// <file>.idx and read from there the next time, if the file has not changed.
+// Requires <string> and <unordered_map> to be included first.
+
+#define HIST_LOAD_BATCH 64              // Spectra loaded at a time by FitHistoFile()
+
+struct HistIndex {
+   TFile *File;
+   TFolder *Folder;                     // "histos" from online analyser files, else 0
+   std::unordered_map < std::string, std::string > Dirs;        // spectrum name -> directory in File, "" for the top
+   std::unordered_map < std::string, TObject * >Objects;        // spectrum name -> object in Folder
+   unsigned int Loaded;                 // spectra read from File and not released
+   unsigned int PeakLoaded;
+   unsigned int TotalLoaded;
+};
+
+// --------------------------------------------------------
+// Functions:
+// --------------------------------------------------------
+// Index File, reading the TFolder too if FileType is 2.  0 if OK.
+int OpenHistIndex(HistIndex * Index, TFile * File, int FileType);
+// Spectrum called Name, 0 if it's not in the file.  Give it back with ReleaseHist().
+TObject *LoadHist(HistIndex * Index, std::string Name);
+// Free a spectrum from LoadHist(), unless it belongs to the folder.  Hist may be 0.
+void ReleaseHist(HistIndex * Index, TObject * Hist);
+// Free the folder and the index, not the file
+void CloseHistIndex(HistIndex * Index);
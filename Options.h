@@ -12,10 +12,14 @@
 // Main loop control
 #define MAX_EVENTS 0
 #define DEBUG_TREE_LOOP 0
+#define BUILD_WINDOW 64          // Number of events held open by the event builder
+#define READ_AHEAD_MB 256        // Memory for reading trees ahead of the sort (-ra), see ReadAhead.h
+#define ALLOC_WARMUP_EVENTS 10000   // Heap allocations are reported separately after this many events
 // ROOT Stuff
 #define ROOT_VIRT_SIZE    1024u*1024u*1024u     // 1x10^7 or ~10Mb seems to run fast-ish but not freeze the system completely.
                                      // that's on my 6Gb 2.6GHz i5 (YMMV)
                                      // Correction: for a longer run file 10^9 was needed
+                                     // Only used with -i -ra 0 now, otherwise see READ_AHEAD_MB
 // Stuff about the experimental setup
 #define CLOVERS  16
 #define CRYSTALS  4
@@ -89,6 +93,26 @@ struct RunConfig {              // this struct will hold all information
    int EventLimit;
    // ROOT stuff
    unsigned int ROOT_MaxVirtSize;
+   unsigned int ReadAheadMB;    // memory for reading trees ahead on a separate thread (-ra), 0 = read on the main thread
+   // Event building
+   bool UseTreeIndex;           // 1 = build events with GetEntryWithIndex(), 0 = sequential event builder
+   int BuildWindow;             // number of events held open by the sequential builder
+   // Threads
+   int NumThreads;              // number of threads sorting events (-j), each has its own copy of the spectra
+   // Run statistics, RunStats.C
+   bool RunStats;               // time each stage and write Config.StatsOut (-t)
+   bool StatsLive;              // also print them with the progress (-tl)
+   std::string StatsOut;
+   // Partial results, Partial.C
+   bool WritePartial;           // save Config.PartialOut for MergePartials instead of the final fits (-P)
+   std::string PartialOut;
+   bool Checkpoint;             // save Config.CheckpointOut after each finished tree, so the sort can be resumed (-K)
+   double CheckpointMinutes;    // but no more often than this
+   std::string CheckpointOut;
+   std::string ResumeFrom;      // checkpoint to start from, its files are not sorted again (-R)
+   // Skims, Skim.C
+   bool WriteSkim;              // write Config.SkimOut, a compact copy of the events sorted without waveforms (-S)
+   std::string SkimOut;
    // Configuration file
    std::string ConfigFile;
 
@@ -98,6 +122,11 @@ struct RunConfig {              // this struct will hold all information
    unsigned int WaveformSamples;
    unsigned int WaveInitialSamples;
    unsigned int WaveFinalSamples;
+   // Waveform analysis, WaveAnalysis.C
+   unsigned int WaveTrapRise;   // samples in each sum of the trapezoidal filter, 0 = off
+   unsigned int WaveTrapGap;    // samples between sums (flat top)
+   unsigned int WaveCfdDelay;   // constant fraction delay in samples, 0 = off
+   float WaveCfdFraction;       // constant fraction
    // integration in charge evaluation
    unsigned int Integration;
    // Dispersion used in charge evaluation
@@ -155,6 +184,8 @@ struct RunConfig {              // this struct will hold all information
    unsigned int TimeBins;
    float TimeBinSize;
    bool FitTempSpectra;  // should the temporary charge spectra be fitted for gain drift check
+   // Input histogram files
+   bool HistIndexCache;  // save the index of spectra in each input file next to it, see HistIndex.h
    // Charge spectra
    int ChargeBins;
    int ChargeBins2D;
@@ -186,7 +217,7 @@ struct RunConfig {              // this struct will hold all information
    // Peak Fitting
    unsigned int MinFitCounts;  // Minimum counts in whole spectrum for fit to be attempted
    float FitWidth_keV;           // Width of region either side of peak to be fitted
-   bool FitBackground;           // 1 = yes, 0 = no.  Should be best to use this all the time but left option there just in case.
+   int FitBackground;            // 1 = constant, 2 = linear, 0 = none.  Should be best to use this all the time but left option there just in case.
    float BackWidth_keV; 
    
    // Initial values for custom fit functions
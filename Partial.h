@@ -0,0 +1,26 @@
+// Partial results (SortTrees -P, MergePartials)
+// ---------------------------------------------------------
+// A sort of some of the files of an experiment can be saved, in place of the final
+// fits and output, as a partial result: a ROOT file with a directory for each sort run
+// holding its raw spectra, accumulators and crosstalk sums (Partial*() in Calib.C,
+// PropXtalk.C, CoincEff.C and GeTiming.C), and a directory Run recording which sorts
+// were run, on which files and how many events were sorted.  MergePartials adds any
+// number of these together and runs the Final*() functions once, so the files of an
+// experiment can be sorted in separate jobs and a failed job only has to be run again.
+// SortTrees -K writes the same thing, listing the files finished so far, as a checkpoint
+// while it sorts, and -R reads one back before sorting the rest.
+// Requires <string> and <vector> to be included first.
+
+// --------------------------------------------------------
+// Functions:
+// --------------------------------------------------------
+// Write the active sorts to FileName, as sorted from Files.  Instead of calling Final*(), or
+// with Keep as a checkpoint after which the sort goes on.  0 if OK.
+int WritePartial(std::string FileName, long long Events, long long Frags, std::vector < std::string > &Files, bool Keep);
+// Set Config.Run* (and the settings which decide what spectra there are) to those of
+// partial FileName.  Call before the Init*() functions.  0 if OK.
+int ReadPartialSorts(std::string FileName);
+// Add partial FileName to the active sorts, its events and frags to *Events, *Frags and, if
+// Files isn't 0, the files it was sorted from to *Files.  Must have been made with the same
+// sorts as ReadPartialSorts() set (or, resuming, as the command line).  0 if OK.
+int ReadPartial(std::string FileName, long long *Events, long long *Frags, std::vector < std::string > *Files);
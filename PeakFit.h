@@ -0,0 +1,38 @@
+// Fits for calibration
+// ---------------------------------------------------------
+// Peaks are fitted with a Gaussian on a linear background by Levenberg-Marquardt
+// with exact derivatives, and calibrations with a polynomial by weighted least
+// squares, so no TF1 or Minuit is needed for each line and channel.  Both are
+// chi-square fits and give the same parameters, errors (from the covariance
+// matrix, not scaled by ChiSq/NDF), ChiSq and NDF as the TH1::Fit() and
+// TGraphErrors::Fit() they replace, to well within the errors.
+// Nothing is allocated and there is no shared state, so these may be called from
+// any thread.
+
+// Peak parameters:  y = Const * exp(-0.5 * ((x - Mean) / Sigma)^2) + ConstantBG + (LinearBG * x)
+#define PEAK_CONST 0
+#define PEAK_MEAN 1
+#define PEAK_SIGMA 2
+#define PEAK_CONSTANT_BG 3
+#define PEAK_LINEAR_BG 4
+#define PEAK_PARS 5
+
+#define PEAK_FIT_MAX_ITER 200           // Levenberg-Marquardt steps before giving up
+#define POLY_FIT_MAX_ORDER 2
+
+// --------------------------------------------------------
+// Functions:
+// --------------------------------------------------------
+// Fit a peak to N points X, Y with errors Err on Y.  Points with Err <= 0 (empty bins) are
+// left out, as TH1::Fit() does.  Par holds the starting values and is set to the result,
+// parameters with Free[p] == 0 are held where they are and have error 0.
+// 0 if the fit converged, 1 if it did not (Par is the best found), -1 if there are too few points.
+int FitPeak(const double *X, const double *Y, const double *Err, int N, double *Par, const bool *Free,
+            double *dPar, double *ChiSq, int *NDF);
+// Value of the peak function at X
+double PeakFunction(double X, const double *Par);
+// Fit a polynomial of order Order (1 or 2) to N points X, Y with errors dX, dY.  Errors on X
+// are included as error on Y times the slope of the fit (effective variance), as
+// TGraphErrors::Fit() does.  Par[0..Order] = offset, gain, quadratic term.  0 if OK.
+int FitPoly(const float *X, const float *Y, const float *dX, const float *dY, int N, int Order,
+            double *Par, double *dPar, double *ChiSq, int *NDF);
@@ -0,0 +1,67 @@
+// Reading trees ahead of the sort (-ra)
+// ---------------------------------------------------------
+// A reader thread opens each file in turn, reads and decompresses its
+// FragmentTree through a TTreeCache and copies the fragments in to chunks of
+// READ_AHEAD_CHUNK_FRAGS, which are queued for the event builder on the main
+// thread.  Each fragment is counted against the memory budget as it is added to
+// a chunk, and when the fragments queued, being built from and being filled reach
+// the budget the chunk is queued as it is and the reader stops, so memory use is
+// fixed (to within a fragment) whatever the size of the trees.  The reader carries
+// on to the next file while the sort is still on the last one, so opening a file
+// doesn't hold up the sort.  Chunks are reused once built from, so once the budget
+// is reached nothing more is allocated.
+// The time the sort spent waiting for fragments (I/O bound) and the reader spent
+// waiting for space (sort bound) are kept to help choose the budget.
+// Requires <thread>, <mutex>, <condition_variable>, <deque>, <string>, <vector> and EventView.h to be included first.
+
+#define READ_AHEAD_CHUNK_FRAGS 4096     // Fragments passed from the reader at a time
+#define READ_AHEAD_CACHE_FRACTION 4     // 1/4 of the budget is the TTreeCache, the rest queued fragments
+
+struct ReadChunk {
+   FragStore Frags;
+   unsigned int File;                   // Index in to ReadAhead.Files
+   unsigned long long Bytes;            // Memory of the fragments, including waveforms
+   bool EndOfFile;                      // Last chunk of File, Entries and BytesRead are set
+   bool Failed;                         // File could not be read
+   long long Entries;
+   long long BytesRead;
+};
+
+struct ReadAhead {
+   std::vector < std::string > Files;
+   unsigned long long Budget;           // Bytes of fragments queued before the reader waits
+   unsigned long long CacheSize;        // TTreeCache of each tree
+   std::thread Thread;
+   std::mutex Lock;                     // protects everything down to Finished
+   std::condition_variable Filled;      // chunk queued or reader finished
+   std::condition_variable Emptied;     // chunk given back or reader told to stop
+   std::deque < ReadChunk * >Full;
+   std::vector < ReadChunk * >Spare;
+   unsigned long long QueuedBytes;      // in Full, being built from and being filled (charged per fragment)
+   unsigned long long PeakBytes;
+   bool Stop;
+   bool Finished;
+   // Main thread only
+   ReadChunk *Current;                  // being built from
+   unsigned int NextFrag;
+   long long FileEntries;               // of the last file finished by NextReadAheadFrag()
+   long long FileBytesRead;
+   bool FileFailed;
+   // Times in ns.  Reader's are only read once it has been stopped.
+   unsigned long long ReadNanosecs;     // reader reading and decompressing
+   unsigned long long FullNanosecs;     // reader waiting for space in the budget
+   unsigned long long WaitNanosecs;     // main thread waiting for fragments
+};
+
+// --------------------------------------------------------
+// Functions:
+// --------------------------------------------------------
+// Start reading Files with a budget of BudgetMB.  0 if OK.
+int StartReadAhead(ReadAhead * Read, std::vector < std::string > &Files, unsigned int BudgetMB);
+// Next fragment, valid until the next call.  0 at the end of each file (FileEntries etc. are
+// then set), after which the next call starts on the next file, and 0 when all are finished.
+TTigFragment *NextReadAheadFrag(ReadAhead * Read);
+// Stop the reader, even if it has not finished, and free the chunks
+void StopReadAhead(ReadAhead * Read);
+// Print the times and memory used
+void PrintReadAhead(ReadAhead * Read);
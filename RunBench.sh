@@ -0,0 +1,124 @@
+#!/bin/bash
+# End to end benchmark of SortTrees and SortHistos on synthetic data from MakeFragTree
+# ---------------------------------------------------------------------------------------
+# Makes a FragmentTree file with known gains and crosstalk, runs the --cal, --prop, --eff and
+# --getim sorts and SortHistos --calspec on it, and reports the wall time, sort rate and peak
+# memory of each stage.  The calibrations found are then checked against what was put in
+# (CheckBench.py), as is that the --eff and --getim spectra have counts in them, so a change that
+# speeds things up but breaks the results shows up.
+# The same settings and seed give the same file, so runs before and after a change compare.
+#
+# Run from the directory with the compiled SortTrees, SortHistos and MakeFragTree.
+# Usage: ./RunBench.sh [-n Events] [-r Rate] [-s 60Co|152Eu] [-c Clovers] [-w WaveSamples]
+#                      [-j Threads] [-o BenchDir] [-k (keep existing data file)] [-- extra MakeFragTree options]
+# Needs /usr/bin/time (GNU) for the memory figures.  Set PYTHON if python is not on the path, it
+# needs PyROOT to check the spectra.
+
+Events=200000
+Rate=1000
+Source=60Co
+Clovers=4
+Samples=200
+Threads=1
+Dir=Bench
+Keep=0
+Bin=$(pwd)
+
+while [ $# -gt 0 ]; do
+   case "$1" in
+      -n) Events=$2; shift 2 ;;
+      -r) Rate=$2; shift 2 ;;
+      -s) Source=$2; shift 2 ;;
+      -c) Clovers=$2; shift 2 ;;
+      -w) Samples=$2; shift 2 ;;
+      -j) Threads=$2; shift 2 ;;
+      -o) Dir=$2; shift 2 ;;
+      -k) Keep=1; shift ;;
+      --) shift; break ;;
+      *) echo "Unknown option $1, see top of RunBench.sh"; exit 2 ;;
+   esac
+done
+
+for Prog in MakeFragTree SortTrees SortHistos; do
+   if [ ! -x "$Bin/$Prog" ]; then
+      echo "$Bin/$Prog not found, compile it first (see README.md)"
+      exit 2
+   fi
+done
+if [ -x /usr/bin/time ]; then
+   Time="/usr/bin/time -v"
+else
+   echo "No /usr/bin/time, peak memory will not be reported"
+   Time=""
+fi
+ConfigOpt=""
+if [ -f "$Bin/Config.txt" ]; then
+   ConfigOpt="-c $Bin/Config.txt"
+fi
+
+mkdir -p "$Dir"
+cd "$Dir" || exit 2
+Here=$(pwd)
+Data=Synth${Source}.root
+Truth=Truth${Source}
+
+# Run one stage in directory Where, output in to Stage.log and Stage.time
+RunStage() {
+   local Stage=$1
+   local Where=$2
+   local Status
+   shift 2
+   echo "Running $Stage..."
+   if [ -n "$Time" ]; then
+      (cd $Where && $Time -o $Here/$Stage.time "$@" > $Here/$Stage.log 2>&1)
+      Status=$?
+   else
+      local Start=$(date +%s.%N)
+      (cd $Where && "$@" > $Here/$Stage.log 2>&1)
+      Status=$?
+      echo "Elapsed (wall clock) time (h:mm:ss or m:ss): $(echo "$(date +%s.%N) - $Start" | bc)" > $Stage.time
+   fi
+   if [ $Status -ne 0 ]; then
+      echo "$Stage failed ($Status), see $Dir/$Stage.log"
+   fi
+}
+
+# Wall time in s, events/s from SortTrees, peak RSS in MB
+Report() {
+   local Stage=$1
+   local Wall=$(sed -n 's/.*Elapsed (wall clock).*: //p' $Stage.time 2>/dev/null | awk -F: '{ t = 0; for (i = 1; i <= NF; i++) t = t * 60 + $i; print t }')
+   local RSS=$(sed -n 's/.*Maximum resident set size (kbytes): //p' $Stage.time 2>/dev/null | awk '{ printf "%.0f", $1 / 1024 }')
+   local EvRate=$(sed -n 's/^\t*\([0-9.e+]*\) events\/s.*/\1/p' $Stage.log 2>/dev/null | tail -1)
+   printf "%-10s %10s %14s %10s\n" $Stage "${Wall:--}" "${EvRate:--}" "${RSS:--}"
+}
+
+if [ $Keep -eq 0 ] || [ ! -f $Data ]; then
+   RunStage Generate . "$Bin/MakeFragTree" -o $Data -t $Truth -n $Events -r $Rate -s $Source -c $Clovers -w $Samples "$@"
+fi
+
+Stages="Generate"
+for Sort in cal prop eff getim; do
+   mkdir -p $Sort
+   Opts=""
+   if [ $Sort = prop ]; then
+      Opts="-w ${Truth}WaveGains.txt"
+   fi
+   RunStage $Sort . "$Bin/SortTrees" $ConfigOpt -f $Data -s $Source -o $Sort/ -j $Threads $Opts --$Sort
+   Stages="$Stages $Sort"
+done
+
+# SortHistos only takes files named as Config.CalOut, so run it where that was written
+mkdir -p calspec
+RunStage calspec cal "$Bin/SortHistos" $ConfigOpt -f CalibOut.root -s $Source -o ../calspec/ -j $Threads --calspec
+Stages="$Stages calspec"
+
+echo
+echo "$Events events, $Rate Hz, $Source, $Clovers clovers, $Samples samples, $Threads threads"
+printf "%-10s %10s %14s %10s\n" Stage "Wall (s)" "Sort (ev/s)" "RSS (MB)"
+for Stage in $Stages; do
+   Report $Stage
+done | tee Summary.txt
+echo
+
+${PYTHON:-python} "$Bin/CheckBench.py" -c $Clovers -g calspec/GainsOut.txt ${Truth}Gains.txt -w calspec/WaveGainsOut.txt ${Truth}WaveGains.txt \
+   -x prop/PropXTalkOut.txt ${Truth}XTalk.txt -s eff/CoincEffOut.root -s getim/GeTimingOut.root
@@ -0,0 +1,70 @@
+// Run statistics (-t)
+// ---------------------------------------------------------
+// Time spent and number of calls for each stage of the sort, fit counts and
+// failures, fragments per event and bytes read from each tree.  Written to
+// RunStats.json in the output path at the end of the run, and with -tl a short
+// summary is also printed with the progress.
+// Stages are timed with StatStart()/StatStop() which read the clock only if
+// -t was given, so with stats off each costs a test of StatsOn.  Each thread
+// adds to its own counters, these are summed when printed or written.
+// Stages can nest: Read is inside Build, ReadWait inside Read, Fit is inside DriftFit and Final.
+
+#include <chrono>
+#include <string>
+
+#define STAT_READ 0             // Tree entries read
+#define STAT_BUILD 1            // Event building, including reading
+#define STAT_ORDERED 2          // Per event work on the main thread (channels, gain drift)
+#define STAT_QUEUE 3            // Handing events to sort threads (-j), including waiting for them
+#define STAT_DECODE 4           // Waveform analysis and decoding
+#define STAT_CALIB 5
+#define STAT_PROP 6
+#define STAT_EFF 7
+#define STAT_GETIM 8
+#define STAT_DRIFT_FIT 9        // Temporary spectrum (gain drift) fits
+#define STAT_FIT 10             // FitGammaSpectrum(), fails are counted
+#define STAT_FINAL 11           // Final*() fits and output
+#define STAT_READ_AHEAD 12      // Reading and decompressing on the read ahead thread (-ra)
+#define STAT_READ_WAIT 13       // Main thread waiting for the read ahead thread, inside Read
+#define STAT_STAGES 14
+
+#define STAT_MAX_FRAGS 64       // Fragments per event counted up to here, more go in the last bin
+
+extern bool StatsOn;
+
+// --------------------------------------------------------
+// Functions:
+// --------------------------------------------------------
+// Switch on collection (Config.RunStats)
+void InitStats();
+// Add Nanosecs and one call to Stage for this thread
+void StatAdd(int Stage, unsigned long long Nanosecs);
+// Count a failure of Stage
+void StatFail(int Stage);
+// Built event of Frags fragments (main thread only)
+void StatEvent(int Frags);
+// Tree finished (main thread only)
+void StatTree(const char *FileName, long long Entries, unsigned int Events, unsigned int Frags, long long BytesRead, double Seconds);
+// Calls and time of each stage so far, for the progress print (-tl)
+void PrintStats();
+// Write everything as JSON.  0 if OK.
+int WriteStats(std::string FileName, double RunTime, double SortTime);
+
+inline unsigned long long StatNow()
+{
+   return std::chrono::duration_cast < std::chrono::nanoseconds >
+       (std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 0 if stats are off, StatStop() then does nothing
+inline unsigned long long StatStart()
+{
+   return StatsOn ? StatNow() : 0;
+}
+
+inline void StatStop(int Stage, unsigned long long Start)
+{
+   if (Start) {
+      StatAdd(Stage, StatNow() - Start);
+   }
+}
@@ -0,0 +1,113 @@
+// Compact columnar skims (SortTrees -S, reading skims with -f)
+// ---------------------------------------------------------
+// A skim keeps only what the sorts use from each fragment, and the waveform
+// charge rather than the waveform.  It is written once by a full sort of the
+// fragment trees, after which sorts of the skim (--eff, --prop, --getim, --cal
+// with other gates or calibrations) stream no TTigFragments, read no waveforms
+// and need no event builder: events are already grouped.  Raw charge is kept so
+// alternate (-e) and wave (-w) calibrations are applied as usual, but wave
+// charge is from the WAVE_INITIAL/FINAL_SAMPLES the skim was made with.
+//
+// The file is a SkimHeader, a table of the channels seen and one array (column)
+// per quantity, each starting on an 8 byte boundary at Offset[] from the start of
+// the file, so it is read by mapping it in to memory and indexing the columns:
+//   SKIM_CHANNELS    SkimChannel[NumChannels]
+//   SKIM_EVENT_START uint64_t[NumEvents + 1]  frags of event i are EventStart[i] to EventStart[i+1]-1
+//   SKIM_TRIGGER_ID  int32_t[NumEvents]
+//   SKIM_CHANNEL     uint16_t[NumFrags]       dense channel number, index in to the channel table
+//   SKIM_CHARGE      int32_t[NumFrags]
+//   SKIM_CHARGE_CAL  float[NumFrags]
+//   SKIM_TIME_TO_TRIG int32_t[NumFrags]
+//   SKIM_MIDAS_TIME  int64_t[NumFrags]
+//   SKIM_WAVE_CHARGE float[NumFrags]          WaveFeatures.Charge, 0 unless SKIM_WAVE_OK
+//   SKIM_WAVE_FLAGS  uint8_t[NumFrags]
+// Numbers are in the byte order of the machine that wrote the skim, files from a
+// machine of the other order are refused.
+// Requires <cstdio>, <stdint.h>, <string>, <vector>, <map> and EventView.h to be included first.
+
+#define SKIM_MAGIC "TIGSKIM"            // 8 bytes with the terminating 0
+#define SKIM_VERSION 1
+#define SKIM_BYTE_ORDER 0x01020304
+#define SKIM_NAME_LENGTH 24             // Channel name, including terminating 0
+#define SKIM_MAX_CHANNELS 65536
+
+// Sections of the file, Offset[] of each
+#define SKIM_CHANNELS 0
+#define SKIM_EVENT_START 1
+#define SKIM_TRIGGER_ID 2
+#define SKIM_CHANNEL 3
+#define SKIM_CHARGE 4
+#define SKIM_CHARGE_CAL 5
+#define SKIM_TIME_TO_TRIG 6
+#define SKIM_MIDAS_TIME 7
+#define SKIM_WAVE_CHARGE 8
+#define SKIM_WAVE_FLAGS 9
+#define SKIM_SECTIONS 10
+
+// Wave flags
+#define SKIM_WAVE_OK 0x01               // WaveFeatures.ChargeOK
+
+struct SkimHeader {
+   char Magic[8];
+   uint32_t Version;
+   uint32_t ByteOrder;                  // SKIM_BYTE_ORDER as written
+   uint64_t NumEvents;
+   uint64_t NumFrags;
+   uint32_t NumChannels;
+   int32_t WaveInitialSamples;          // Waveform settings the wave charge was found with
+   int32_t WaveFinalSamples;
+   int32_t Spare;
+   uint64_t Offset[SKIM_SECTIONS];
+};
+
+struct SkimChannel {
+   int32_t Address;                     // ChannelAddress
+   int32_t Number;                      // ChannelNumber
+   char Name[SKIM_NAME_LENGTH];         // ChannelName, truncated if longer
+};
+
+struct SkimWriter {
+   std::string FileName;
+   FILE *Columns[SKIM_SECTIONS];        // Temporary file for each column, joined by CloseSkimWriter()
+   std::vector < SkimChannel > Channels;
+   std::map < int, int >ChannelIndex;   // Channel table index by address
+   uint64_t NumEvents;
+   uint64_t NumFrags;
+};
+
+struct SkimReader {
+   std::string FileName;
+   int Fd;
+   size_t Size;
+   const char *Map;                     // Whole file mapped read only
+   const SkimHeader *Header;
+   const SkimChannel *Channels;
+   const uint64_t *EventStart;
+   const int32_t *TriggerId;
+   const uint16_t *Channel;
+   const int32_t *Charge;
+   const float *ChargeCal;
+   const int32_t *TimeToTrig;
+   const int64_t *MidasTime;
+   const float *WaveCharge;
+   const uint8_t *WaveFlags;
+   uint64_t NextEvent;
+};
+
+// --------------------------------------------------------
+// Functions:
+// --------------------------------------------------------
+// Start writing skim FileName.  0 if OK.
+int OpenSkimWriter(SkimWriter * Skim, std::string FileName);
+// Add a built event.  Waveforms should have been analysed (ev.Waves), if not there is no
+// wave charge.  Main thread only, events are stored in the order they are added.  0 if OK.
+int WriteSkimEvent(SkimWriter * Skim, EventView & ev);
+// Finish the file.  0 if OK.
+int CloseSkimWriter(SkimWriter * Skim);
+// Read the header of FileName in to *Header.  0 if it is a skim this code can read.
+int ReadSkimHeader(std::string FileName, SkimHeader * Header);
+// Map skim FileName in to memory and check it.  0 if OK.
+int OpenSkim(SkimReader * Skim, std::string FileName);
+// Fill ev with the next event, waveforms already analysed.  0 if OK, 1 when the skim is exhausted.
+int ReadSkimEvent(SkimReader * Skim, FragStore * ev);
+void CloseSkim(SkimReader * Skim);
@@ -0,0 +1,30 @@
+// Sorting built events on more than one thread (-j N)
+// ---------------------------------------------------------
+// The main thread reads and builds events then hands them out in batches.
+// Batch n always goes to thread n % N and each thread fills its own copy
+// (shard) of the spectra, so the spectra in each shard, and their sum, do not
+// depend on how the threads happen to be scheduled.
+// Requires EventView.h to be included first.
+
+#define SORT_BATCH_EVENTS 256    // Events per batch handed to a thread
+#define SORT_MAX_QUEUED 4        // Batches queued per thread before the main thread waits
+
+struct SortJob {                // One built event
+   unsigned long long DitherSeed;       // EventDitherSeed() of the event
+   FragStore Frags;
+};
+
+struct SortBatch {
+   unsigned int NumJobs;        // Jobs in use, the vector is kept full size so fragments are reused
+   std::vector < SortJob > Jobs;
+};
+
+// --------------------------------------------------------
+// Functions:
+// --------------------------------------------------------
+// Start NumThreads threads, thread i fills shard i of the spectra
+int StartWorkers(int NumThreads);
+// Queue event for sorting.  The fragments are swapped out so ev is returned empty.
+void QueueEvent(FragStore * ev, unsigned long long DitherSeed);
+// Sort anything still queued and wait for the threads to finish
+void StopWorkers();
@@ -3,6 +3,17 @@
 // GRSISpoon libraries
 #include "TTigFragment.h"
 #include <vector>
+#include <TH1.h>
+#include <THnSparse.h>
+
+struct EventView;               // EventView.h
+class TDirectory;
+
+// Modes for ShardHisto()
+#define SHARD_CLONE 0
+#define SHARD_MERGE 1
+#define SHARD_WRITE 2           // Write Master to the partial result (SetPartialDir()), Shard not used
+#define SHARD_READ 3            // Add the same object read back from a partial result to Master
 
 // --------------------------------------------------------
 // Functions:
@@ -15,12 +26,57 @@ int Col2Num(char Colour);
 char Num2Col(int Crystal);
 int GetDaqItemNum(int Clover,int Crystal,int Seg);
 // Calibration
+void SetDitherSeed(unsigned long long Seed);
+unsigned long long EventDitherSeed(EventView & ev);
+double DitherUniform();
 int ReadCalibrationFile(std::string filename, vector < string > *EnCalibNames,vector < vector < float >>*EnCalibValues);
-float CalibrateEnergy(int Charge, std::vector < float >Coefficients);
+float CalibrateEnergy(int Charge, const std::vector < float > &Coefficients);
 // Waveform energy
-float CalcWaveCharge(std::vector < int >wavebuffer);
-float CalibrateWaveEnergy(float Charge, std::vector < float >Coefficients);
+float CalcWaveCharge(const std::vector < int > &wavebuffer);
+float CalibrateWaveEnergy(float Charge, const std::vector < float > &Coefficients);
 // Hit evaluation
 int TestChargeHit(float Charge, int Integration, int Threshold);
 // Save events
-int SaveEvent(std::vector < TTigFragment > &ev, std::string Message);
+int SaveEvent(EventView & ev, std::string Message);
+
+// Partial results (SortTrees -P, MergePartials)
+// SHARD_WRITE and SHARD_READ go through the same Shard*() lists as the thread shards, so a
+// sort reads its objects back in the order it wrote them.  Objects are keyed by their number
+// in that order, so a partial can only be read by the same sort with the same settings.
+// Anything missing or binned differently is skipped and counted (PartialFails()).
+void SetPartialDir(TDirectory * Dir);   // Also restarts the numbering and the count of fails
+int PartialFails();
+void SkipPartial(const char *What);     // Count a fail and skip the next object
+void PartialHisto(TH1 * Master, int Mode);
+void PartialHisto(THnSparse * Master, int Mode);
+// Next histogram of the partial, checked against the binning of Master but not added.  0 if
+// missing, otherwise the caller deletes it.
+TH1 *ReadPartialHisto(TH1 * Master);
+
+// Per-thread histogram shards (-j N)
+// SHARD_CLONE: *Shard becomes an empty copy of Master, not attached to any file
+// SHARD_MERGE: *Shard is added to Master and deleted.  Shards should be merged in the same
+//              order every time so the result doesn't depend on thread timing.
+// SHARD_WRITE/SHARD_READ: as above
+template < class T > void ShardHisto(T * Master, T ** Shard, int Mode)
+{
+   if (Mode == SHARD_CLONE) {
+      *Shard = (T *) Master->Clone();
+      (*Shard)->SetDirectory(0);
+      (*Shard)->Reset();
+   } else if (Mode == SHARD_MERGE) {
+      Master->Add(*Shard);
+      delete *Shard;
+      *Shard = 0;
+   } else {
+      PartialHisto(Master, Mode);
+   }
+}
+
+// THnSparse isn't attached to a file so there is no SetDirectory()
+void ShardHisto(THnSparseF * Master, THnSparseF ** Shard, int Mode);
+// Counters and sums, as ShardHisto().  Shards start zeroed, and are zeroed by SHARD_MERGE, so
+// SHARD_CLONE does nothing.
+void ShardArray(unsigned int *Master, unsigned int *Shard, unsigned int Num, int Mode);
+void ShardArray(long long *Master, long long *Shard, unsigned int Num, int Mode);
+void ShardArray(double *Master, double *Shard, unsigned int Num, int Mode);
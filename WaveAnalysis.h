@@ -0,0 +1,15 @@
+// Waveform analysis
+// ---------------------------------------------------------
+// Every waveform in an event is analysed once, before the event is passed to
+// the sorts, and the results kept in the FragStore (ev.Waves[Frag] in the
+// sorts).  Calib() and PropXtalk() both use the same results rather than each
+// working out the charge again.
+// Requires EventView.h to be included first.
+
+// --------------------------------------------------------
+// Functions:
+// --------------------------------------------------------
+// Analyse the waveforms of all fragments in the store
+void AnalyseWaves(FragStore * Store);
+// Analyse one waveform.  Baseline and charge are the same as CalcWaveCharge().
+void AnalyseWave(const int *Samples, unsigned int Length, WaveFeatures * Wave);